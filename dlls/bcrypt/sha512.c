@@ -29,6 +29,10 @@ static ULONG64 ror(ULONG64 n, int k) { return (n >> k) | (n << (64-k)); }
 #define S1(x)      (ror(x,14) ^ ror(x,18) ^ ror(x,41))
 #define R0(x)      (ror(x,1) ^ ror(x,8) ^ (x>>7))
 #define R1(x)      (ror(x,19) ^ ror(x,61) ^ (x>>6))
+#define ROUND(a,b,c,d,e,f,g,h,i) \
+    t1 = h + S1(e) + Ch(e,f,g) + K[i] + W[i]; \
+    d += t1; \
+    h = t1 + S0(a) + Maj(a,b,c)
 #define ULL(a,b)   (((ULONG64)(a) << 32) | (b))
 
 static const ULONG64 K[80] =
@@ -57,7 +61,7 @@ static const ULONG64 K[80] =
 
 static void processblock(SHA512_CTX *ctx, const UCHAR *buffer)
 {
-    ULONG64 W[80], t1, t2, a, b, c, d, e, f, g, h;
+    ULONG64 W[80], t1, a, b, c, d, e, f, g, h;
     int i;
 
     for (i = 0; i < 16; i++)
@@ -84,18 +88,17 @@ static void processblock(SHA512_CTX *ctx, const UCHAR *buffer)
     g = ctx->h[6];
     h = ctx->h[7];
 
-    for (i = 0; i < 80; i++)
+    /* rotate the variable names instead of moving the values around */
+    for (i = 0; i < 80; i += 8)
     {
-        t1 = h + S1(e) + Ch(e,f,g) + K[i] + W[i];
-        t2 = S0(a) + Maj(a,b,c);
-        h = g;
-        g = f;
-        f = e;
-        e = d + t1;
-        d = c;
-        c = b;
-        b = a;
-        a = t1 + t2;
+        ROUND(a,b,c,d,e,f,g,h,i);
+        ROUND(h,a,b,c,d,e,f,g,i+1);
+        ROUND(g,h,a,b,c,d,e,f,i+2);
+        ROUND(f,g,h,a,b,c,d,e,i+3);
+        ROUND(e,f,g,h,a,b,c,d,i+4);
+        ROUND(d,e,f,g,h,a,b,c,i+5);
+        ROUND(c,d,e,f,g,h,a,b,i+6);
+        ROUND(b,c,d,e,f,g,h,a,i+7);
     }
 
     ctx->h[0] += a;
@@ -1969,7 +1969,8 @@ static int fdi_decomp(const struct fdi_file *fi, int savemode, fdi_decomp_state
       if (CAB(fdi)->read(cab->cabhf, buf, cfdata_SIZEOF) != cfdata_SIZEOF)
         return DECR_INPUT;
 
-      if (CAB(fdi)->seek(cab->cabhf, cab->mii.block_resv, SEEK_CUR) == -1)
+      if (cab->mii.block_resv &&
+          CAB(fdi)->seek(cab->cabhf, cab->mii.block_resv, SEEK_CUR) == -1)
         return DECR_INPUT;
 
       /* we shouldn't get blocks over CAB_INPUTMAX in size */
@@ -2680,8 +2681,9 @@ BOOL __cdecl FDICopy(
 
         TRACE("Resetting folder for file %s.\n", debugstr_a(file->filename));
 
-        /* free stuff for the old decompressor */
-        switch (ct2) {
+        /* free stuff for the old decompressor, the window is kept
+         * and reused by the init functions if the type is unchanged */
+        if (ct1 != ct2) switch (ct2) {
         case cffoldCOMPTYPE_LZX:
           if (LZX(window)) {
             fdi->free(LZX(window));
@@ -1535,20 +1535,25 @@ static BOOL compare_cert_by_cert_id(PCCERT_CONTEXT pCertContext, DWORD dwType,
         break;
     case CERT_ID_KEY_IDENTIFIER:
     {
+        BYTE stack_buf[20], *buf = stack_buf;
         DWORD size = 0;
 
         ret = CertGetCertificateContextProperty(pCertContext,
          CERT_KEY_IDENTIFIER_PROP_ID, NULL, &size);
         if (ret && size == id->u.KeyId.cbData)
         {
-            LPBYTE buf = CryptMemAlloc(size);
+            /* key identifiers are usually SHA-1 hashes, avoid allocating
+             * memory for each certificate in the store */
+            if (size > sizeof(stack_buf))
+                buf = CryptMemAlloc(size);
 
             if (buf)
             {
                 CertGetCertificateContextProperty(pCertContext,
                  CERT_KEY_IDENTIFIER_PROP_ID, buf, &size);
                 ret = !memcmp(buf, id->u.KeyId.pbData, size);
-                CryptMemFree(buf);
+                if (buf != stack_buf)
+                    CryptMemFree(buf);
             }
             else
                 ret = FALSE;
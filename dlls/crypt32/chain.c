@@ -1995,13 +1995,8 @@ static PCCERT_CONTEXT CRYPT_FindIssuer(const CertificateChainEngine *engine, con
     if(prev_issuer)
         return NULL;
 
-    if(engine->hWorld) {
-        issuer = CertFindCertificateInStore(engine->hWorld, cert->dwCertEncodingType, 0, type, para, NULL);
-        if(issuer) {
-            TRACE("Found in world %p\n", issuer);
-            return issuer;
-        }
-    }
+    /* The chain's store is a collection that already includes the engine's
+     * world store, so there is no need to search that one again. */
 
     res = CryptGetObjectUrl(URL_OID_CERTIFICATE_ISSUER, (void*)cert, 0, NULL, &size, NULL, NULL, NULL);
     if(!res)
@@ -412,6 +412,51 @@ static GpStatus get_clip_hrgn(GpGraphics *graphics, HRGN *hrgn)
     return stat;
 }
 
+/* Blend ARGB data directly into the rows of a 32bpp RGB or ARGB bitmap,
+ * avoiding the per-pixel format dispatch of GdipBitmapGet/SetPixel. */
+static void alpha_blend_bmp_pixels_32bpp(GpBitmap *dst_bitmap, INT dst_x, INT dst_y,
+    const BYTE *src, INT src_width, INT src_height, INT src_stride, PixelFormat fmt,
+    CompositingMode comp_mode)
+{
+    const ARGB dst_alpha = dst_bitmap->format == PixelFormat32bppRGB ? 0xff000000 : 0;
+    const ARGB dst_mask = dst_bitmap->format == PixelFormat32bppRGB ? 0x00ffffff : 0xffffffff;
+    INT x, y, x_start = 0, y_start = 0;
+
+    /* Pixels outside the bitmap are silently dropped by GdipBitmapSetPixel. */
+    if (dst_x < 0) x_start = -dst_x;
+    if (dst_y < 0) y_start = -dst_y;
+    src_width = min(src_width, dst_bitmap->width - dst_x);
+    src_height = min(src_height, dst_bitmap->height - dst_y);
+
+    for (y=y_start; y<src_height; y++)
+    {
+        const ARGB *src_row = (const ARGB*)(src + src_stride * y);
+        ARGB *dst_row = (ARGB*)(dst_bitmap->bits + dst_bitmap->stride * (y + dst_y)) + dst_x;
+
+        if (comp_mode == CompositingModeSourceCopy)
+        {
+            for (x=x_start; x<src_width; x++)
+                dst_row[x] = (src_row[x] & 0xff000000) ? src_row[x] & dst_mask : 0;
+        }
+        else if (fmt & PixelFormatPAlpha)
+        {
+            for (x=x_start; x<src_width; x++)
+            {
+                if (src_row[x] & 0xff000000)
+                    dst_row[x] = color_over_fgpremult(dst_row[x] | dst_alpha, src_row[x]) & dst_mask;
+            }
+        }
+        else
+        {
+            for (x=x_start; x<src_width; x++)
+            {
+                if (src_row[x] & 0xff000000)
+                    dst_row[x] = color_over(dst_row[x] | dst_alpha, src_row[x]) & dst_mask;
+            }
+        }
+    }
+}
+
 /* Draw ARGB data to the given graphics object */
 static GpStatus alpha_blend_bmp_pixels(GpGraphics *graphics, INT dst_x, INT dst_y,
     const BYTE *src, INT src_width, INT src_height, INT src_stride, const PixelFormat fmt)
@@ -422,6 +467,14 @@ static GpStatus alpha_blend_bmp_pixels(GpGraphics *graphics, INT dst_x, INT dst_
 
     GdipGetCompositingMode(graphics, &comp_mode);
 
+    if (dst_bitmap->bits && (dst_bitmap->format == PixelFormat32bppARGB ||
+        dst_bitmap->format == PixelFormat32bppRGB))
+    {
+        alpha_blend_bmp_pixels_32bpp(dst_bitmap, dst_x, dst_y, src, src_width, src_height,
+            src_stride, fmt, comp_mode);
+        return Ok;
+    }
+
     for (y=0; y<src_height; y++)
     {
         for (x=0; x<src_width; x++)
@@ -600,12 +653,9 @@ static GpStatus alpha_blend_pixels(GpGraphics *graphics, INT dst_x, INT dst_y,
     return alpha_blend_pixels_hrgn(graphics, dst_x, dst_y, src, src_width, src_height, src_stride, NULL, fmt);
 }
 
-static ARGB blend_colors(ARGB start, ARGB end, REAL position)
+static ARGB blend_colors_pos(ARGB start, ARGB end, INT pos)
 {
     INT start_a, end_a, final_a;
-    INT pos;
-
-    pos = gdip_round(position * 0xff);
 
     start_a = ((start >> 24) & 0xff) * (pos ^ 0xff);
     end_a = ((end >> 24) & 0xff) * pos;
@@ -620,7 +670,12 @@ static ARGB blend_colors(ARGB start, ARGB end, REAL position)
         (((start & 0xff) * start_a + ((end & 0xff) * end_a)) / final_a);
 }
 
-static ARGB blend_line_gradient(GpLineGradient* brush, REAL position)
+static ARGB blend_colors(ARGB start, ARGB end, REAL position)
+{
+    return blend_colors_pos(start, end, gdip_round(position * 0xff));
+}
+
+static REAL line_gradient_blendfac(GpLineGradient* brush, REAL position)
 {
     REAL blendfac;
 
@@ -660,6 +715,13 @@ static ARGB blend_line_gradient(GpLineGradient* brush, REAL position)
                     right_blendfac * (position - left_blendpos)) / range;
     }
 
+    return blendfac;
+}
+
+static ARGB blend_line_gradient(GpLineGradient* brush, REAL position)
+{
+    REAL blendfac = line_gradient_blendfac(brush, position);
+
     if (brush->pblendcount == 0)
         return blend_colors(brush->startcolor, brush->endcolor, blendfac);
     else
@@ -1203,9 +1265,9 @@ static GpStatus brush_fill_pixels(GpGraphics *graphics, GpBrush *brush,
     {
         int x, y;
         GpSolidFill *fill = (GpSolidFill*)brush;
-        for (x=0; x<fill_area->Width; x++)
-            for (y=0; y<fill_area->Height; y++)
-                argb_pixels[x + y*cdwStride] = fill->color;
+        for (y=0; y<fill_area->Height; y++, argb_pixels += cdwStride)
+            for (x=0; x<fill_area->Width; x++)
+                argb_pixels[x] = fill->color;
         return Ok;
     }
     case BrushTypeHatchFill:
@@ -1276,13 +1338,41 @@ static GpStatus brush_fill_pixels(GpGraphics *graphics, GpBrush *brush,
             REAL x_delta = draw_points[1].X - draw_points[0].X;
             REAL y_delta = draw_points[2].X - draw_points[0].X;
 
-            for (y=0; y<fill_area->Height; y++)
+            if (fill->pblendcount == 0)
             {
-                for (x=0; x<fill_area->Width; x++)
+                ARGB colors[256];
+
+                /* Without preset colors the result only depends on the
+                 * blend factor rounded to 8 bits, so precompute those. */
+                for (x=0; x<256; x++)
+                    colors[x] = blend_colors_pos(fill->startcolor, fill->endcolor, x);
+
+                for (y=0; y<fill_area->Height; y++)
                 {
-                    REAL pos = draw_points[0].X + x * x_delta + y * y_delta;
+                    DWORD *row = argb_pixels + y*cdwStride;
+
+                    for (x=0; x<fill_area->Width; x++)
+                    {
+                        REAL pos = draw_points[0].X + x * x_delta + y * y_delta;
+                        INT index = gdip_round(line_gradient_blendfac(fill, pos) * 0xff);
 
-                    argb_pixels[x + y*cdwStride] = blend_line_gradient(fill, pos);
+                        if (index >= 0 && index <= 0xff)
+                            row[x] = colors[index];
+                        else
+                            row[x] = blend_colors_pos(fill->startcolor, fill->endcolor, index);
+                    }
+                }
+            }
+            else
+            {
+                for (y=0; y<fill_area->Height; y++)
+                {
+                    for (x=0; x<fill_area->Width; x++)
+                    {
+                        REAL pos = draw_points[0].X + x * x_delta + y * y_delta;
+
+                        argb_pixels[x + y*cdwStride] = blend_line_gradient(fill, pos);
+                    }
                 }
             }
         }
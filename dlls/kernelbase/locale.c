@@ -2529,6 +2529,38 @@ static void inc_str_pos( const WCHAR **str, int *len, unsigned int *dpos, unsign
 }
 
 
+/* length of the common prefix of two strings, comparing four chars at a time */
+static int get_common_prefix( const WCHAR *str1, const WCHAR *str2, int len )
+{
+    UINT64 val1, val2;
+    int pos;
+
+    for (pos = 0; pos + 4 <= len; pos += 4)
+    {
+        memcpy( &val1, str1 + pos, sizeof(val1) );
+        memcpy( &val2, str2 + pos, sizeof(val2) );
+        if (val1 != val2) break;
+    }
+    while (pos < len && str1[pos] == str2[pos]) pos++;
+    return pos;
+}
+
+
+/* ASCII letters and digits have no decomposition, non-zero primary weights and are
+ * not symbols, so a common prefix of such chars compares equal in every pass */
+static int get_common_alnum_prefix( const WCHAR *str1, const WCHAR *str2, int len )
+{
+    int pos;
+
+    for (pos = 0; pos < len && str1[pos] == str2[pos]; pos++)
+    {
+        WCHAR ch = str1[pos] | 0x20;
+        if ((ch < 'a' || ch > 'z') && (str1[pos] < '0' || str1[pos] > '9')) break;
+    }
+    return pos;
+}
+
+
 static int compare_weights(int flags, const WCHAR *str1, int len1,
                            const WCHAR *str2, int len2, enum weight type )
 {
@@ -3086,6 +3118,14 @@ INT WINAPI CompareStringEx( const WCHAR *locale, DWORD flags, const WCHAR *str1,
     if (len1 < 0) len1 = lstrlenW(str1);
     if (len2 < 0) len2 = lstrlenW(str2);
 
+    if (len1 == len2 && get_common_prefix( str1, str2, len1 ) == len1) return CSTR_EQUAL;
+
+    ret = get_common_alnum_prefix( str1, str2, min( len1, len2 ));
+    str1 += ret;
+    len1 -= ret;
+    str2 += ret;
+    len2 -= ret;
+
     ret = compare_weights( flags, str1, len1, str2, len2, UNICODE_WEIGHT );
     if (!ret)
     {
@@ -3206,7 +3246,8 @@ INT WINAPI DECLSPEC_HOTPATCH CompareStringOrdinal( const WCHAR *str1, INT len1,
     if (len1 < 0) len1 = lstrlenW( str1 );
     if (len2 < 0) len2 = lstrlenW( str2 );
 
-    ret = RtlCompareUnicodeStrings( str1, len1, str2, len2, ignore_case );
+    ret = get_common_prefix( str1, str2, min( len1, len2 ));
+    ret = RtlCompareUnicodeStrings( str1 + ret, len1 - ret, str2 + ret, len2 - ret, ignore_case );
     if (ret < 0) return CSTR_LESS_THAN;
     if (ret > 0) return CSTR_GREATER_THAN;
     return CSTR_EQUAL;
@@ -3629,7 +3670,11 @@ INT WINAPI DECLSPEC_HOTPATCH FindStringOrdinal( DWORD flag, const WCHAR *src, IN
     inc = flag & (FIND_FROMSTART | FIND_STARTSWITH) ? 1 : -1;
     while (count--)
     {
-        if (CompareStringOrdinal( src + offset, val_size, val, val_size, ignore_case ) == CSTR_EQUAL)
+        int prefix = get_common_prefix( src + offset, val, val_size );
+
+        if (prefix == val_size) return offset;
+        if (ignore_case && !RtlCompareUnicodeStrings( src + offset + prefix, val_size - prefix,
+                                                      val + prefix, val_size - prefix, TRUE ))
             return offset;
         offset += inc;
     }
@@ -605,6 +605,12 @@ static int decode_lzxd_block(struct LZXD_dec *dec, BYTE *base, size_t predef_siz
             }
 
             end = min(index + length, block_limit);
+            if (end > index && dist >= end - index)
+            {
+                /* source and destination don't overlap */
+                memcpy(base + index, base + index - dist, end - index);
+                index = end;
+            }
             while (index < end)
             {
                 base[index] = base[index - dist];
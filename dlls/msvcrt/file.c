@@ -2831,15 +2831,36 @@ static int read_i(int fd, ioinfo *fdinfo, void *buf, unsigned int count)
         }
         else if (fdinfo->wxflag & WX_TEXT)
         {
-            DWORD i, j;
+            DWORD i, j, limit = num_read;
 
             if (bufstart[0]=='\n' && (!utf16 || bufstart[1]==0))
                 fdinfo->wxflag |= WX_READNL;
             else
                 fdinfo->wxflag &= ~WX_READNL;
 
+            if (!utf16)
+            {
+                const char *eof = memchr(bufstart, 0x1a, num_read);
+                if (eof) limit = eof - bufstart;
+            }
+
             for (i=0, j=0; i<num_read; i+=1+utf16)
             {
+                if (!utf16)
+                {
+                    /* move runs of characters that need no translation in one go */
+                    const char *cr = memchr(bufstart + i, '\r', limit - i);
+                    DWORD len = (cr ? cr - bufstart : limit) - i;
+
+                    if (len)
+                    {
+                        memmove(bufstart + j, bufstart + i, len);
+                        i += len;
+                        j += len;
+                        if (i == num_read) break;
+                    }
+                }
+
                 /* in text mode, a ctrl-z signals EOF */
                 if (bufstart[i]==0x1a && (!utf16 || bufstart[i+1]==0))
                 {
@@ -3774,19 +3795,37 @@ char * CDECL fgets(char *s, int size, FILE* file)
 
   _lock_file(file);
 
-  while ((size >1) && (cc = _fgetc_nolock(file)) != EOF && cc != '\n')
+  while (size > 1)
+  {
+    if (file->_cnt > 0)
     {
-      *s++ = (char)cc;
-      size --;
+      /* copy straight from the stream buffer, up to and including a newline */
+      int len = min(file->_cnt, size - 1);
+      char *nl = memchr(file->_ptr, '\n', len);
+
+      if (nl) len = nl - file->_ptr + 1;
+      memcpy(s, file->_ptr, len);
+      s += len;
+      size -= len;
+      file->_ptr += len;
+      file->_cnt -= len;
+      if (nl) break;
+      continue;
     }
+
+    if ((cc = _fgetc_nolock(file)) == EOF)
+      break;
+    *s++ = (char)cc;
+    size--;
+    if (cc == '\n')
+      break;
+  }
   if ((cc == EOF) && (s == buf_start)) /* If nothing read, return 0*/
   {
     TRACE(":nothing read\n");
     _unlock_file(file);
     return NULL;
   }
-  if ((cc != EOF) && (size > 1))
-    *s++ = cc;
   *s = '\0';
   TRACE(":got %s\n", debugstr_a(buf_start));
   _unlock_file(file);
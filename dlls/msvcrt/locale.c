@@ -1921,20 +1921,31 @@ static pthreadlocinfo create_locinfo(int category,
  */
 _locale_t CDECL _create_locale(int category, const char *locale)
 {
+    pthreadlocinfo cur_locinfo = NULL;
+    pthreadmbcinfo cur_mbcinfo = NULL;
     _locale_t loc;
 
+    /* Share the tables of categories that match the current thread locale
+     * instead of building them again. Other categories than the requested
+     * one default to "C", so this is only possible for LC_ALL. */
+    if(MSVCRT_locale) {
+        if(category == LC_ALL)
+            cur_locinfo = get_locinfo();
+        cur_mbcinfo = get_mbcinfo();
+    }
+
     loc = malloc(sizeof(_locale_tstruct));
     if(!loc)
         return NULL;
 
-    loc->locinfo = create_locinfo(category, locale, NULL);
+    loc->locinfo = create_locinfo(category, locale, cur_locinfo);
     if(!loc->locinfo) {
         free(loc);
         return NULL;
     }
 
     loc->mbcinfo = create_mbcinfo(loc->locinfo->lc_id[LC_CTYPE].wCodePage,
-            loc->locinfo->lc_handle[LC_CTYPE], NULL);
+            loc->locinfo->lc_handle[LC_CTYPE], cur_mbcinfo);
     if(!loc->mbcinfo) {
         free_locinfo(loc->locinfo);
         free(loc);
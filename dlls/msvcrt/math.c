@@ -546,6 +546,7 @@ recompute:
     return n & 7;
 }
 
+#if _MSVCR_VER>=120
 /* Based on musl implementation: src/math/round.c */
 static double __round(double x)
 {
@@ -566,6 +567,18 @@ static double __round(double x)
     llx &= ~tmp;
     return *(double*)&llx;
 }
+#endif
+
+/* Same as (INT64)__round(x), for |x| < 2^62 */
+static inline INT64 __round_int64(double x)
+{
+    INT64 k = (INT64)x;
+    double r = x - k;
+
+    if (r >= 0.5) k++;
+    else if (r <= -0.5) k--;
+    return k;
+}
 
 #if !defined(__i386__) || _MSVCR_VER >= 120
 /* Copied from musl: src/math/expm1f.c */
@@ -1231,8 +1244,8 @@ float CDECL expf( float x )
     /* Round and convert z to int, the result is in [-150*N, 128*N] and
        ideally ties-to-even rule is used, otherwise the magnitude of r
        can be bigger which gives larger approximation error.  */
-    kd = __round(z);
-    ki = (INT64)kd;
+    ki = __round_int64(z);
+    kd = ki;
     r = z - kd;
 
     /* exp(x) = 2^(k/N) * 2^(r/N) ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
@@ -1535,8 +1548,8 @@ static float powf_exp2(double xd, UINT32 sign_bias)
     double kd, z, r, r2, y, s;
 
     /* N*x = k + r with r in [-1/2, 1/2] */
-    kd = __round(xd); /* k */
-    ki = (INT64)kd;
+    ki = __round_int64(xd); /* k */
+    kd = ki;
     r = xd - kd;
 
     /* exp2(x) = 2^(k/N) * 2^r ~= s * (C0*r^3 + C1*r^2 + C2*r + 1) */
@@ -3019,8 +3032,8 @@ double CDECL exp( double x )
     /* exp(x) = 2^(k/N) * exp(r), with exp(r) in [2^(-1/2N),2^(1/2N)]. */
     /* x = ln2/N*k + r, with int k and r in [-ln2/2N, ln2/2N]. */
     z = invln2N * x;
-    kd = __round(z);
-    ki = (INT64)kd;
+    ki = __round_int64(z);
+    kd = ki;
 
     r = x + kd * negln2hiN + kd * negln2loN;
     /* 2^(k/N) ~= scale * (1 + tail). */
@@ -3851,8 +3864,8 @@ static double pow_exp(double argx, double argy, double x, double xtail, UINT32 s
     /* exp(x) = 2^(k/N) * exp(r), with exp(r) in [2^(-1/2N),2^(1/2N)]. */
     /* x = ln2/N*k + r, with int k and r in [-ln2/2N, ln2/2N]. */
     z = invln2N * x;
-    kd = __round(z);
-    ki = (INT64)kd;
+    ki = __round_int64(z);
+    kd = ki;
     r = x + kd * negln2hiN + kd * negln2loN;
     /* The code assumes 2^-200 < |xtail| < 2^-8/N. */
     r += xtail;
@@ -607,12 +607,20 @@ static inline int FUNC_NAME(pf_output_fp)(FUNC_NAME(puts_clbk) pf_puts, void *pu
     if(v) {
         m = (ULONGLONG)1 << (MANT_BITS - 1);
         m |= (*(ULONGLONG*)&v & (((ULONGLONG)1 << (MANT_BITS - 1)) - 1));
+        e2 -= MANT_BITS;
+        /* drop trailing zero bits, so that integers and short binary fractions
+         * need fewer shifts below */
+        for(; !(m & 1); m >>= 1) e2++;
         b->b = 0;
-        b->e = 2;
         b->size = BNUM_PREC64;
         b->data[0] = m % LIMB_MAX;
         b->data[1] = m / LIMB_MAX;
-        e2 -= MANT_BITS;
+        if(b->data[1]) {
+            b->e = 2;
+        } else {
+            b->e = 1;
+            e10 = -LIMB_DIGITS;
+        }
 
         while(e2 > 0) {
             int shift = e2 > 29 ? 29 : e2;
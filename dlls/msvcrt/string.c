@@ -36,6 +36,11 @@
 
 WINE_DEFAULT_DEBUG_CHANNEL(msvcrt);
 
+/* helpers for scanning memory a machine word at a time */
+#define WORD_ONES  ((size_t)~0 / 0xff)
+#define WORD_HIGHS (WORD_ONES * 0x80)
+#define WORD_HAS_ZERO_BYTE(w) (((w) - WORD_ONES) & ~(w) & WORD_HIGHS)
+
 /*********************************************************************
  *		_mbsdup (MSVCRT.@)
  *		_strdup (MSVCRT.@)
@@ -742,6 +747,64 @@ static inline BOOL bnum_to_mant(struct bnum *b, ULONGLONG *m)
     return TRUE;
 }
 
+static inline int ull_bits(ULONGLONG v)
+{
+    DWORD idx;
+
+    if(v >> 32) {
+        BitScanReverse(&idx, v >> 32);
+        return idx + 33;
+    }
+    if(!v) return 0;
+    BitScanReverse(&idx, v);
+    return idx + 1;
+}
+
+/* Converts m * 10^e10 to fpnum without using bnum. Returns FALSE if the value can't
+ * be represented exactly by the returned mantissa and rounding mode. */
+static BOOL fpnum_from_dec(int sign, ULONGLONG m, int e10, struct fpnum *ret)
+{
+    static const ULONGLONG p5s[] = {
+        1ull, 5ull, 25ull, 125ull, 625ull, 3125ull, 15625ull, 78125ull, 390625ull,
+        1953125ull, 9765625ull, 48828125ull, 244140625ull, 1220703125ull, 6103515625ull,
+        30517578125ull, 152587890625ull, 762939453125ull, 3814697265625ull,
+        19073486328125ull, 95367431640625ull, 476837158203125ull, 2384185791015625ull,
+        11920928955078125ull, 59604644775390625ull, 298023223876953125ull,
+        1490116119384765625ull, 7450580596923828125ull
+    };
+    ULONGLONG d, r;
+    int e2, shift;
+
+    if(!m) return FALSE;
+
+    if(e10 >= 0) {
+        /* 10^e10 = 5^e10 * 2^e10 */
+        if(e10 >= ARRAY_SIZE(p5s) || m > UI64_MAX / p5s[e10]) return FALSE;
+        *ret = fpnum(sign, e10, m * p5s[e10], FP_ROUND_ZERO);
+        return TRUE;
+    }
+
+    if(-e10 >= ARRAY_SIZE(p5s)) return FALSE;
+    d = p5s[-e10];
+    r = m % d;
+    m /= d;
+    e2 = e10;
+
+    /* produce quotient bits until the mantissa is full, r < d < 2^63 */
+    while(!(m >> 63)) {
+        shift = 64 - max(ull_bits(m), ull_bits(d));
+        r <<= shift;
+        m = (m << shift) | (r / d);
+        r %= d;
+        e2 -= shift;
+    }
+
+    if(!r) *ret = fpnum(sign, e2, m, FP_ROUND_ZERO);
+    else if(2 * r > d) *ret = fpnum(sign, e2, m, FP_ROUND_UP);
+    else *ret = fpnum(sign, e2, m, FP_ROUND_DOWN);
+    return TRUE;
+}
+
 static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(void *ctx),
         void *ctx, pthreadlocinfo locinfo, BOOL ldouble, struct bnum *b)
 {
@@ -755,7 +818,10 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     int e2 = 0, dp=0, sign=1, off, limb_digits = 0, i;
     enum fpmod round = FP_ROUND_ZERO;
     wchar_t nch;
-    ULONGLONG m;
+    ULONGLONG m, dec_m = 0;
+    int dec_digits = 0;
+    BOOL dec_exact = TRUE;
+    struct fpnum ret;
 
     nch = get(ctx);
     if(nch == '-') {
@@ -826,11 +892,18 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(dec_digits < 19) {
+            dec_m = dec_m * 10 + nch - '0';
+            dec_digits++;
+        } else if(nch != '0') {
+            dec_exact = FALSE;
+        }
         nch = get(ctx);
         dp++;
     }
     while(nch>='0' && nch<='9') {
         if(nch != '0') b->data[bnum_idx(b, b->b)] |= 1;
+        if(nch != '0') dec_exact = FALSE;
         nch = get(ctx);
         dp++;
     }
@@ -862,10 +935,17 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
 
         b->data[bnum_idx(b, b->b)] = b->data[bnum_idx(b, b->b)] * 10 + nch - '0';
         limb_digits++;
+        if(dec_digits < 19) {
+            dec_m = dec_m * 10 + nch - '0';
+            dec_digits++;
+        } else if(nch != '0') {
+            dec_exact = FALSE;
+        }
         nch = get(ctx);
     }
     while(nch>='0' && nch<='9') {
         if(nch != '0') b->data[bnum_idx(b, b->b)] |= 1;
+        if(nch != '0') dec_exact = FALSE;
         nch = get(ctx);
     }
 
@@ -917,6 +997,13 @@ static struct fpnum fpnum_parse_bnum(wchar_t (*get)(void *ctx), void (*unget)(vo
     if(!b->data[bnum_idx(b, b->e-1)])
         return fpnum(sign, 0, 0, 0);
 
+    /* Inputs with up to 19 significant digits and a small exponent can be
+     * converted exactly with 64-bit arithmetic. Trailing zeros beyond the
+     * 19th digit only move the decimal point. */
+    if(dec_exact && dp >= dec_digits - 30 && dp <= dec_digits + 30 &&
+            fpnum_from_dec(sign, dec_m, dp - dec_digits, &ret))
+        return ret;
+
     /* Fill last limb with 0 if needed */
     if(b->b+1 != b->e) {
         for(; limb_digits != LIMB_DIGITS; limb_digits++)
@@ -1513,7 +1600,14 @@ int CDECL _atoldbl(_LDOUBLE *value, char *str)
 size_t __cdecl strlen(const char *str)
 {
     const char *s = str;
-    while (*s) s++;
+    const size_t *w;
+
+    for (; (size_t)s % sizeof(size_t); s++)
+        if (!*s) return s - str;
+
+    /* aligned reads never cross a page boundary */
+    for (w = (const size_t *)s; !WORD_HAS_ZERO_BYTE(*w); w++);
+    for (s = (const char *)w; *s; s++);
     return s - str;
 }
 
@@ -2680,9 +2774,14 @@ int CDECL I10_OUTPUT(MSVCRT__LDOUBLE ld80, int prec, int flag, struct _I10_OUTPU
  */
 int __cdecl memcmp(const void *ptr1, const void *ptr2, size_t n)
 {
-    const unsigned char *p1, *p2;
+    typedef size_t DECLSPEC_ALIGN(1) unaligned_size_t;
+    const unsigned char *p1 = ptr1, *p2 = ptr2;
 
-    for (p1 = ptr1, p2 = ptr2; n; n--, p1++, p2++)
+    /* skip the equal part a word at a time */
+    for (; n >= sizeof(size_t); n -= sizeof(size_t), p1 += sizeof(size_t), p2 += sizeof(size_t))
+        if (*(const unaligned_size_t *)p1 != *(const unaligned_size_t *)p2) break;
+
+    for (; n; n--, p1++, p2++)
     {
         if (*p1 < *p2) return -1;
         if (*p1 > *p2) return 1;
@@ -3172,9 +3271,19 @@ char* __cdecl strrchr(const char *str, int c)
  */
 void* __cdecl memchr(const void *ptr, int c, size_t n)
 {
+    const size_t v = WORD_ONES * (unsigned char)c;
     const unsigned char *p = ptr;
 
-    for (p = ptr; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+    for (; n && (size_t)p % sizeof(size_t); n--, p++)
+        if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
+
+    for (; n >= sizeof(size_t); n -= sizeof(size_t), p += sizeof(size_t))
+    {
+        size_t w = *(const size_t *)p ^ v;
+        if (WORD_HAS_ZERO_BYTE(w)) break;
+    }
+
+    for (; n; n--, p++) if (*p == (unsigned char)c) return (void *)(ULONG_PTR)p;
     return NULL;
 }
 
@@ -1980,6 +1980,10 @@ static void test__strtod(void)
         { ".00", 3, 0 },
         { "-0.", 3, 0 },
         { "0e13", 4, 0 },
+        { "9007199254740993", 16, 9007199254740992.0 },
+        { "1e23", 4, 1e23 },
+        { "123456789012345678e-5", 21, 1234567890123.45678 },
+        { "0.000123456789", 14, 0.000123456789 },
     };
     const char overflow[] = "1d9999999999999999999";
 
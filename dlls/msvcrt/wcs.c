@@ -2876,8 +2876,16 @@ wchar_t* CDECL wcsrchr(const wchar_t *str, wchar_t ch)
  */
 size_t CDECL wcslen(const wchar_t *str)
 {
+    const size_t ones = (size_t)~0 / 0xffff, highs = ones * 0x8000;
     const wchar_t *s = str;
-    while (*s) s++;
+    const size_t *w;
+
+    for (; (size_t)s % sizeof(size_t); s++)
+        if (!*s) return s - str;
+
+    /* aligned reads never cross a page boundary */
+    for (w = (const size_t *)s; !((*w - ones) & ~*w & highs); w++);
+    for (s = (const wchar_t *)w; *s; s++);
     return s - str;
 }
 
@@ -146,15 +146,16 @@ struct LFH_heap
 {
     LFH_slist *list_defer;
     LFH_arena *cached_large_arena;
+    LFH_arena *cached_block_arena;
 
     LFH_class block_class[TOTAL_BLOCK_CLASS_COUNT];
     LFH_class large_class[TOTAL_LARGE_CLASS_COUNT];
 
     SLIST_ENTRY entry_orphan;
 #ifdef _WIN64
-    void *pad[0xc2];
+    void *pad[0xc0];
 #else
-    void *pad[0xc3];
+    void *pad[0xc2];
 #endif
 };
 
@@ -489,6 +490,7 @@ static inline LFH_arena *LFH_acquire_arena(LFH_heap *heap, LFH_class *class)
 static inline BOOLEAN LFH_release_arena(LFH_heap *heap, LFH_arena *arena)
 {
     LFH_arena *large_arena = LFH_large_arena_from_block((LFH_block *)arena);
+    if (arena == heap->cached_block_arena) heap->cached_block_arena = NULL;
     if (arena == large_arena && !heap->cached_large_arena)
     {
         heap->cached_large_arena = arena;
@@ -520,6 +522,21 @@ static inline BOOLEAN LFH_deallocate_block(LFH_heap *heap, LFH_arena *arena, LFH
     if (LFH_arena_is_used(arena))
         return TRUE;
 
+    /* keep the last arena of a block class, so that allocation churn on an
+     * otherwise idle class doesn't release and re-acquire it every time, but
+     * only one per heap, releasing the previous one if it is still unused */
+    if (LFH_class_is_block(heap, class) && class->next == arena && !arena->class_entry)
+    {
+        LFH_arena *cached = heap->cached_block_arena;
+
+        heap->cached_block_arena = arena;
+        if (!cached || cached == arena || LFH_arena_is_used(cached))
+            return TRUE;
+
+        arena = cached;
+        class = LFH_class_from_arena(arena);
+    }
+
     LFH_class_remove_arena(class, arena);
     return LFH_release_arena(heap, arena);
 }
@@ -535,6 +552,7 @@ static void LFH_heap_initialize(LFH_heap *heap)
 
     heap->list_defer = NULL;
     heap->cached_large_arena = NULL;
+    heap->cached_block_arena = NULL;
 }
 
 static SLIST_HEADER *LFH_orphan_list(void)
@@ -575,7 +593,7 @@ static void LFH_heap_finalize(LFH_heap *heap)
     {
         while ((arena = LFH_class_pop_arena(&heap->block_class[i])))
         {
-            WARN("block arena %p still has used blocks\n", arena);
+            if (LFH_arena_is_used(arena)) WARN("block arena %p still has used blocks\n", arena);
             LFH_release_arena(heap, arena);
         }
     }
@@ -1244,6 +1244,50 @@ found:
 }
 
 
+/* helpers to process runs of 7-bit ASCII a word at a time; they return the number of
+ * characters converted, stopping before the first block containing a non-ASCII char */
+static inline unsigned int utf8_ascii_count( const char *src, unsigned int srclen )
+{
+    unsigned int pos = 0;
+    UINT64 val;
+
+    for (pos = 0; pos + sizeof(val) <= srclen; pos += sizeof(val))
+    {
+        memcpy( &val, src + pos, sizeof(val) );
+        if (val & 0x8080808080808080ull) break;
+    }
+    return pos;
+}
+
+static inline unsigned int utf8_ascii_to_utf16( WCHAR *dst, const char *src, unsigned int len )
+{
+    unsigned int i, pos;
+    UINT64 val;
+
+    for (pos = 0; pos + sizeof(val) <= len; pos += sizeof(val))
+    {
+        memcpy( &val, src + pos, sizeof(val) );
+        if (val & 0x8080808080808080ull) break;
+        for (i = 0; i < sizeof(val); i++) dst[pos + i] = (unsigned char)src[pos + i];
+    }
+    return pos;
+}
+
+static inline unsigned int utf16_ascii_to_utf8( char *dst, const WCHAR *src, unsigned int len )
+{
+    unsigned int i, pos;
+    UINT64 val;
+
+    for (pos = 0; pos + 4 <= len; pos += 4)
+    {
+        memcpy( &val, src + pos, sizeof(val) );
+        if (val & 0xff80ff80ff80ff80ull) break;
+        for (i = 0; i < 4; i++) dst[pos + i] = src[pos + i];
+    }
+    return pos;
+}
+
+
 /* helper for the various utf8 mbstowcs functions */
 static unsigned int decode_utf8_char( unsigned char ch, const char **str, const char *strend )
 {
@@ -1316,7 +1360,13 @@ NTSTATUS WINAPI RtlUTF8ToUnicodeN( WCHAR *dst, DWORD dstlen, DWORD *reslen, cons
     {
         for (len = 0; src < srcend; len++)
         {
-            unsigned char ch = *src++;
+            unsigned char ch;
+            unsigned int count = utf8_ascii_count( src, srcend - src );
+
+            src += count;
+            len += count;
+            if (src == srcend) break;
+            ch = *src++;
             if (ch < 0x80) continue;
             if ((res = decode_utf8_char( ch, &src, srcend )) > 0x10ffff)
                 status = STATUS_SOME_NOT_MAPPED;
@@ -1333,6 +1383,9 @@ NTSTATUS WINAPI RtlUTF8ToUnicodeN( WCHAR *dst, DWORD dstlen, DWORD *reslen, cons
         if (ch < 0x80)  /* special fast case for 7-bit ASCII */
         {
             *dst++ = ch;
+            len = utf8_ascii_to_utf16( dst, src, min( dstend - dst, srcend - src ));
+            dst += len;
+            src += len;
             continue;
         }
         if ((res = decode_utf8_char( ch, &src, srcend )) <= 0xffff)
@@ -1407,6 +1460,10 @@ NTSTATUS WINAPI RtlUnicodeToUTF8N( char *dst, DWORD dstlen, DWORD *reslen, const
         {
             if (dst > end - 1) break;
             *dst++ = ch;
+            len = utf16_ascii_to_utf8( dst, src + 1, min( end - dst, srclen - 1 ));
+            dst += len;
+            src += len;
+            srclen -= len;
             continue;
         }
         if (ch < 0x800)  /* 0x80-0x7ff: 2 bytes */
@@ -1454,22 +1511,15 @@ NTSTATUS WINAPI RtlUnicodeToUTF8N( char *dst, DWORD dstlen, DWORD *reslen, const
 }
 
 
-/******************************************************************************
- *      RtlIsNormalizedString   (NTDLL.@)
- */
-NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BOOLEAN *res )
+/* Unicode quick check: result is 1 for Yes, 0 for No and -1 for Maybe */
+static NTSTATUS quick_check_string( const struct norm_table *info, const WCHAR *str, int len, int *result )
 {
-    const struct norm_table *info;
-    NTSTATUS status;
     BYTE props, class, last_class = 0;
     unsigned int ch;
-    int i, r, result = 1;
-
-    if ((status = load_norm_table( form, &info ))) return status;
+    int i, r;
 
-    if (len == -1) len = wcslen( str );
-
-    for (i = 0; i < len && result; i += r)
+    *result = 1;
+    for (i = 0; i < len && *result; i += r)
     {
         if (!(r = get_utf16( str + i, len - i, &ch ))) return STATUS_NO_UNICODE_TRANSLATION;
         if (info->comp_size)
@@ -1477,13 +1527,13 @@ NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BO
             if ((ch >= HANGUL_VBASE && ch < HANGUL_VBASE + HANGUL_VCOUNT) ||
                 (ch >= HANGUL_TBASE && ch < HANGUL_TBASE + HANGUL_TCOUNT))
             {
-                result = -1;  /* QC=Maybe */
+                *result = -1;  /* QC=Maybe */
                 continue;
             }
         }
         else if (ch >= HANGUL_SBASE && ch < HANGUL_SBASE + HANGUL_SCOUNT)
         {
-            result = 0;  /* QC=No */
+            *result = 0;  /* QC=No */
             break;
         }
         props = get_char_props( info, ch );
@@ -1491,7 +1541,7 @@ NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BO
         if (class == 0x3f)
         {
             last_class = 0;
-            if (props == 0xbf) result = 0;  /* QC=No */
+            if (props == 0xbf) *result = 0;  /* QC=No */
             else if (props == 0xff)
             {
                 /* ignore other chars in Hangul range */
@@ -1504,12 +1554,30 @@ NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BO
         }
         else if (props & 0x80)
         {
-            if ((props & 0xc0) == 0xc0) result = -1;  /* QC=Maybe */
-            if (class && class < last_class) result = 0;  /* QC=No */
+            if ((props & 0xc0) == 0xc0) *result = -1;  /* QC=Maybe */
+            if (class && class < last_class) *result = 0;  /* QC=No */
             last_class = class;
         }
         else last_class = 0;
     }
+    return STATUS_SUCCESS;
+}
+
+
+/******************************************************************************
+ *      RtlIsNormalizedString   (NTDLL.@)
+ */
+NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BOOLEAN *res )
+{
+    const struct norm_table *info;
+    NTSTATUS status;
+    int result;
+
+    if ((status = load_norm_table( form, &info ))) return status;
+
+    if (len == -1) len = wcslen( str );
+
+    if ((status = quick_check_string( info, str, len, &result ))) return status;
 
     if (result == -1)
     {
@@ -1531,7 +1599,7 @@ NTSTATUS WINAPI RtlIsNormalizedString( ULONG form, const WCHAR *str, INT len, BO
  */
 NTSTATUS WINAPI RtlNormalizeString( ULONG form, const WCHAR *src, INT src_len, WCHAR *dst, INT *dst_len )
 {
-    int buf_len;
+    int buf_len, result;
     WCHAR *buf = NULL;
     const struct norm_table *info;
     NTSTATUS status = STATUS_SUCCESS;
@@ -1554,6 +1622,14 @@ NTSTATUS WINAPI RtlNormalizeString( ULONG form, const WCHAR *src, INT src_len, W
         return STATUS_SUCCESS;
     }
 
+    /* strings that pass the quick check are already normalized */
+    if (*dst_len >= src_len && !quick_check_string( info, src, src_len, &result ) && result == 1)
+    {
+        memcpy( dst, src, src_len * sizeof(WCHAR) );
+        *dst_len = src_len;
+        return STATUS_SUCCESS;
+    }
+
     if (!info->comp_size) return decompose_string( info, src, src_len, dst, dst_len );
 
     buf_len = src_len * 4;
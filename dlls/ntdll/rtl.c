@@ -554,8 +554,14 @@ VOID WINAPI RtlZeroMemory( VOID *Destination, SIZE_T Length )
  */
 SIZE_T WINAPI RtlCompareMemory( const VOID *Source1, const VOID *Source2, SIZE_T Length)
 {
+    typedef SIZE_T DECLSPEC_ALIGN(1) unaligned_size_t;
     SIZE_T i;
-    for(i=0; (i<Length) && (((const BYTE*)Source1)[i]==((const BYTE*)Source2)[i]); i++);
+
+    /* skip the equal part a word at a time */
+    for(i=0; i + sizeof(SIZE_T) <= Length &&
+        *(const unaligned_size_t *)((const BYTE*)Source1 + i) == *(const unaligned_size_t *)((const BYTE*)Source2 + i);
+        i += sizeof(SIZE_T));
+    for(; (i<Length) && (((const BYTE*)Source1)[i]==((const BYTE*)Source2)[i]); i++);
     return i;
 }
 
@@ -2392,6 +2392,11 @@ static const struct utf8_to_unicode_test utf8_to_unicode[] = {
     { "-\xC3\xA7\xCC\x81-", { '-',0x00e7,0x0301,'-',0 }, STATUS_SUCCESS },
     { "-\x63\xCC\xA7\xCC\x81-", { '-',0x0063,0x0327,0x0301,'-',0 }, STATUS_SUCCESS },
     { "-\x63\xCC\x81\xCC\xA7-", { '-',0x0063,0x0301,0x0327,'-',0 }, STATUS_SUCCESS },
+    /* long ASCII runs around multibyte and invalid sequences */
+    { "abcdefghijklmnop\xC3\xA9qrstuvwxyz0123\x80" "456789ABCDEFGHIJ",
+      { 'a','b','c','d','e','f','g','h','i','j','k','l','m','n','o','p',0xe9,'q','r','s','t','u','v','w',
+        'x','y','z','0','1','2','3',0xfffd,'4','5','6','7','8','9','A','B','C','D','E','F','G','H','I','J',0 },
+      STATUS_SOME_NOT_MAPPED },
 };
 
 static void unicode_expect_(const WCHAR *out_string, ULONG buflen, ULONG out_chars,
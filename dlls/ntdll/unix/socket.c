@@ -27,6 +27,9 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#ifdef HAVE_SYS_SENDFILE_H
+# include <sys/sendfile.h>
+#endif
 #include <unistd.h>
 #ifdef HAVE_IFADDRS_H
 # include <ifaddrs.h>
@@ -142,6 +145,7 @@ struct async_transmit_ioctl
     unsigned int buffer_cursor; /* amount of data currently in the buffer already sent */
     unsigned int tail_cursor;   /* amount of tail data already sent */
     unsigned int file_len;      /* total file length to send */
+    BOOL use_sendfile;          /* file data can be sent with sendfile() */
     DWORD flags;
     const char *head;
     const char *tail;
@@ -584,8 +588,12 @@ static NTSTATUS try_recv( int fd, struct async_recv_ioctl *async, ULONG_PTR *siz
     hdr.msg_iov = async->iov;
     hdr.msg_iovlen = async->count;
 #ifndef HAVE_STRUCT_MSGHDR_MSG_ACCRIGHTS
-    hdr.msg_control = control_buffer;
-    hdr.msg_controllen = sizeof(control_buffer);
+    /* don't make the kernel build control messages nobody asked for */
+    if (async->control)
+    {
+        hdr.msg_control = control_buffer;
+        hdr.msg_controllen = sizeof(control_buffer);
+    }
 #endif
     while ((ret = virtual_locked_recvmsg( fd, &hdr, async->unix_flags )) < 0 && errno == EINTR);
 
@@ -944,15 +952,30 @@ static ssize_t do_send( int fd, const void *buffer, size_t len, int flags )
     return ret;
 }
 
+/* the header is sent with MSG_MORE when file data follows; if the file turns
+ * out to be empty and there is no tail, push it out instead of leaving it corked */
+static void flush_transmit_head( int sock_fd, struct async_transmit_ioctl *async )
+{
+#ifdef MSG_MORE
+    if (async->head_len && !async->tail_len) do_send( sock_fd, NULL, 0, 0 );
+#endif
+}
+
 static NTSTATUS try_transmit( int sock_fd, int file_fd, struct async_transmit_ioctl *async )
 {
+    int head_flags = 0;
     ssize_t ret;
 
+#ifdef MSG_MORE
+    /* don't push out the header in a packet of its own */
+    if (async->file || async->tail_len) head_flags = MSG_MORE;
+#endif
+
     while (async->head_cursor < async->head_len)
     {
         TRACE( "sending %u bytes of header data\n", async->head_len - async->head_cursor );
         ret = do_send( sock_fd, async->head + async->head_cursor,
-                       async->head_len - async->head_cursor, 0 );
+                       async->head_len - async->head_cursor, head_flags );
         if (ret < 0) return sock_errno_to_status( errno );
         TRACE( "send returned %zd\n", ret );
         async->head_cursor += ret;
@@ -969,6 +992,42 @@ static NTSTATUS try_transmit( int sock_fd, int file_fd, struct async_transmit_io
         async->file_cursor += ret;
     }
 
+#ifdef HAVE_SYS_SENDFILE_H
+    while (async->file && async->use_sendfile)
+    {
+        size_t size = async->file_len ? async->file_len - async->file_cursor : 0x7ffff000;
+        off_t offset = async->offset.QuadPart;
+
+        TRACE( "sending %zu bytes of file data with sendfile\n", size );
+        if (async->offset.QuadPart == FILE_USE_FILE_POINTER_POSITION)
+            ret = sendfile( sock_fd, file_fd, NULL, size );
+        else
+            ret = sendfile( sock_fd, file_fd, &offset, size );
+        if (ret < 0)
+        {
+            if (errno == EINTR) continue;
+            if (errno == EINVAL || errno == ENOSYS || errno == EOPNOTSUPP)
+            {
+                /* not supported for this file, fall back to copying the data */
+                TRACE( "sendfile failed: %s\n", strerror( errno ) );
+                async->use_sendfile = FALSE;
+                break;
+            }
+            if (errno != EWOULDBLOCK) WARN( "sendfile: %s\n", strerror( errno ) );
+            return sock_errno_to_status( errno );
+        }
+        TRACE( "sendfile returned %zd\n", ret );
+
+        async->file_cursor += ret;
+        if (async->offset.QuadPart != FILE_USE_FILE_POINTER_POSITION)
+            async->offset.QuadPart += ret;
+
+        if (!ret || (async->file_len && async->file_cursor == async->file_len))
+            async->file = NULL;
+        if (!ret) flush_transmit_head( sock_fd, async );
+    }
+#endif
+
     if (async->file && async->buffer_cursor == async->read_len)
     {
         unsigned int read_size = async->buffer_size;
@@ -994,6 +1053,7 @@ static NTSTATUS try_transmit( int sock_fd, int file_fd, struct async_transmit_io
 
         if (ret < read_size || (async->file_len && async->file_cursor == async->file_len))
             async->file = NULL;
+        if (!ret) flush_transmit_head( sock_fd, async );
         return STATUS_DEVICE_NOT_READY; /* still more data to send */
     }
 
@@ -1087,6 +1147,7 @@ static NTSTATUS sock_transmit( HANDLE handle, HANDLE event, PIO_APC_ROUTINE apc,
     async->buffer_cursor = 0;
     async->tail_cursor = 0;
     async->file_len = params->file_len;
+    async->use_sendfile = TRUE;
     async->flags = params->flags;
     async->head = u64_to_user_ptr(params->head_ptr);
     async->head_len = params->head_len;
@@ -101,6 +101,7 @@ static const struct wined3d_extension_map gl_extension_map[] =
     {"GL_ARB_multisample",                  ARB_MULTISAMPLE               },
     {"GL_ARB_multitexture",                 ARB_MULTITEXTURE              },
     {"GL_ARB_occlusion_query",              ARB_OCCLUSION_QUERY           },
+    {"GL_ARB_parallel_shader_compile",      ARB_PARALLEL_SHADER_COMPILE   },
     {"GL_ARB_pipeline_statistics_query",    ARB_PIPELINE_STATISTICS_QUERY },
     {"GL_ARB_pixel_buffer_object",          ARB_PIXEL_BUFFER_OBJECT       },
     {"GL_ARB_point_parameters",             ARB_POINT_PARAMETERS          },
@@ -2221,6 +2222,8 @@ static void load_gl_funcs(struct wined3d_gl_info *gl_info)
     USE_GL_FUNC(glGetQueryObjectivARB)
     USE_GL_FUNC(glGetQueryObjectuivARB)
     USE_GL_FUNC(glIsQueryARB)
+    /* GL_ARB_parallel_shader_compile */
+    USE_GL_FUNC(glMaxShaderCompilerThreadsARB)
     /* GL_ARB_point_parameters */
     USE_GL_FUNC(glPointParameterfARB)
     USE_GL_FUNC(glPointParameterfvARB)
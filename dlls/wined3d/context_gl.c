@@ -2260,6 +2260,13 @@ HRESULT wined3d_context_gl_init(struct wined3d_context_gl *context_gl, struct wi
         }
     }
 
+    if (gl_info->supported[ARB_PARALLEL_SHADER_COMPILE])
+    {
+        /* Let the driver pick the number of compiler threads. */
+        GL_EXTCALL(glMaxShaderCompilerThreadsARB(~0u));
+        checkGLcall("glMaxShaderCompilerThreadsARB");
+    }
+
     if (gl_info->supported[ARB_PROVOKING_VERTEX])
     {
         GL_EXTCALL(glProvokingVertex(GL_FIRST_VERTEX_CONVENTION));
@@ -20,6 +20,7 @@
 #include "wined3d_private.h"
 
 WINE_DEFAULT_DEBUG_CHANNEL(d3d);
+WINE_DECLARE_DEBUG_CHANNEL(d3d_perf);
 WINE_DECLARE_DEBUG_CHANNEL(d3d_sync);
 WINE_DECLARE_DEBUG_CHANNEL(fps);
 
@@ -135,6 +136,12 @@ enum wined3d_cs_op
     WINED3D_CS_OP_STOP,
 };
 
+struct wined3d_cs_op_stats
+{
+    unsigned int count;
+    ULONG64 ticks;
+};
+
 struct wined3d_cs_packet
 {
     size_t size;
@@ -639,6 +646,43 @@ static struct wined3d_cs_packet *wined3d_next_cs_packet(const uint8_t *data, SIZ
     return packet;
 }
 
+static void wined3d_cs_report_op_stats(struct wined3d_cs *cs)
+{
+    LARGE_INTEGER now, freq;
+    unsigned int i;
+
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&freq);
+
+    /* every 1.5 seconds */
+    if ((now.QuadPart - cs->op_stats_time.QuadPart) * 2 < freq.QuadPart * 3)
+        return;
+
+    for (i = 0; i < WINED3D_CS_OP_STOP; ++i)
+    {
+        const struct wined3d_cs_op_stats *stats = &cs->op_stats[i];
+
+        if (!stats->count)
+            continue;
+
+        TRACE_(d3d_perf)("%s: %u packets, %.3f ms total, %.3f us average.\n", debug_cs_op(i), stats->count,
+                1000.0 * stats->ticks / freq.QuadPart, 1000000.0 * stats->ticks / freq.QuadPart / stats->count);
+    }
+
+    if (cs->thread)
+    {
+        TRACE_(d3d_perf)("Queue: %lu bytes peak usage, %u stalls, %.3f ms stalled, %u waits, spin limit %u.\n",
+                (unsigned long)cs->max_queue_usage, cs->stall_count,
+                1000.0 * cs->stall_ticks / freq.QuadPart, cs->wait_count, cs->spin_limit);
+        cs->max_queue_usage = 0;
+        cs->stall_count = cs->wait_count = 0;
+        cs->stall_ticks = 0;
+    }
+
+    memset(cs->op_stats, 0, WINED3D_CS_OP_STOP * sizeof(*cs->op_stats));
+    cs->op_stats_time = now;
+}
+
 static void wined3d_cs_exec_nop(struct wined3d_cs *cs, const void *data)
 {
 }
@@ -727,6 +771,9 @@ static void wined3d_cs_exec_present(struct wined3d_cs *cs, const void *data)
         wined3d_resource_release(&swapchain->back_buffers[i]->resource);
     }
 
+    if (cs->op_stats)
+        wined3d_cs_report_op_stats(cs);
+
     InterlockedDecrement(&cs->pending_presents);
 }
 
@@ -3021,6 +3068,26 @@ static void (* const wined3d_cs_op_handlers[])(struct wined3d_cs *cs, const void
     /* WINED3D_CS_OP_EXECUTE_COMMAND_LIST        */ wined3d_cs_exec_execute_command_list,
 };
 
+/* Packets executed from a command list are accounted individually; the
+ * WINED3D_CS_OP_EXECUTE_COMMAND_LIST time includes them. */
+static void wined3d_cs_exec_op(struct wined3d_cs *cs, enum wined3d_cs_op opcode, const void *data)
+{
+    LARGE_INTEGER start, end;
+
+    if (!cs->op_stats)
+    {
+        wined3d_cs_op_handlers[opcode](cs, data);
+        return;
+    }
+
+    QueryPerformanceCounter(&start);
+    wined3d_cs_op_handlers[opcode](cs, data);
+    QueryPerformanceCounter(&end);
+
+    ++cs->op_stats[opcode].count;
+    cs->op_stats[opcode].ticks += end.QuadPart - start.QuadPart;
+}
+
 static void wined3d_cs_exec_execute_command_list(struct wined3d_cs *cs, const void *data)
 {
     const struct wined3d_cs_execute_command_list *op = data;
@@ -3037,7 +3104,7 @@ static void wined3d_cs_exec_execute_command_list(struct wined3d_cs *cs, const vo
         if (opcode >= WINED3D_CS_OP_STOP)
             ERR("Invalid opcode %#x.\n", opcode);
         else
-            wined3d_cs_op_handlers[opcode](cs, packet->data);
+            wined3d_cs_exec_op(cs, opcode, packet->data);
         TRACE("%s executed.\n", debug_cs_op(opcode));
     }
 }
@@ -3104,7 +3171,7 @@ static void wined3d_cs_st_submit(struct wined3d_device_context *context, enum wi
     if (opcode >= WINED3D_CS_OP_STOP)
         ERR("Invalid opcode %#x.\n", opcode);
     else
-        wined3d_cs_op_handlers[opcode](cs, &data[start]);
+        wined3d_cs_exec_op(cs, opcode, &data[start]);
 
     if (cs->data == data)
         cs->start = cs->end = start;
@@ -3224,6 +3291,13 @@ static void wined3d_cs_queue_submit(struct wined3d_cs_queue *queue, struct wined
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[packet->size]);
     InterlockedExchange(&queue->head, (queue->head + packet_size) & (WINED3D_CS_QUEUE_SIZE - 1));
 
+    if (cs->op_stats)
+    {
+        size_t usage = (queue->head - *(volatile LONG *)&queue->tail) & (WINED3D_CS_QUEUE_SIZE - 1);
+
+        cs->max_queue_usage = max(cs->max_queue_usage, usage);
+    }
+
     if (InterlockedCompareExchange(&cs->waiting_for_event, FALSE, TRUE))
         SetEvent(cs->event);
 }
@@ -3238,11 +3312,25 @@ static void wined3d_cs_mt_submit(struct wined3d_device_context *context, enum wi
     wined3d_cs_queue_submit(&cs->queue[queue_id], cs);
 }
 
+static void wined3d_cs_queue_wait_for_space(struct wined3d_cs *cs, struct wined3d_cs_queue *queue, LONG tail)
+{
+    InterlockedExchange(&cs->waiting_for_space, TRUE);
+
+    /* The CS thread may have consumed packets after we read "tail", but
+     * before "waiting_for_space" was set. In that case it won't wake us up. */
+    if (*(volatile LONG *)&queue->tail == tail)
+        RtlWaitOnAddress(&queue->tail, &tail, sizeof(tail), NULL);
+
+    InterlockedExchange(&cs->waiting_for_space, FALSE);
+}
+
 static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size_t size, struct wined3d_cs *cs)
 {
     size_t queue_size = ARRAY_SIZE(queue->data);
     size_t header_size, packet_size, remaining;
     struct wined3d_cs_packet *packet;
+    LARGE_INTEGER stall_start, stall_end;
+    unsigned int spin_count = 0;
 
     header_size = FIELD_OFFSET(struct wined3d_cs_packet, data[0]);
     packet_size = FIELD_OFFSET(struct wined3d_cs_packet, data[size]);
@@ -3293,6 +3381,23 @@ static void *wined3d_cs_queue_require_space(struct wined3d_cs_queue *queue, size
 
         TRACE("Waiting for free space. Head %u, tail %u, packet size %lu.\n",
                 head, tail, (unsigned long)packet_size);
+
+        if (!spin_count++ && cs->op_stats)
+            QueryPerformanceCounter(&stall_start);
+
+        /* The CS thread is usually just about to retire a packet, but if it
+         * is stuck on something expensive, sleep instead of burning CPU. */
+        if (spin_count < WINED3D_CS_QUEUE_SPIN_COUNT)
+            YieldProcessor();
+        else
+            wined3d_cs_queue_wait_for_space(cs, queue, tail);
+    }
+
+    if (spin_count && cs->op_stats)
+    {
+        QueryPerformanceCounter(&stall_end);
+        cs->stall_ticks += stall_end.QuadPart - stall_start.QuadPart;
+        ++cs->stall_count;
     }
 
     packet = (struct wined3d_cs_packet *)&queue->data[queue->head];
@@ -3373,6 +3478,23 @@ static void wined3d_cs_wait_event(struct wined3d_cs *cs)
     WaitForSingleObject(cs->event, INFINITE);
 }
 
+static void wined3d_cs_update_spin_limit(struct wined3d_cs *cs, unsigned int spin_count, BOOL waited)
+{
+    int limit = cs->spin_limit;
+
+    /* Aim to spin for about twice as long as the longer idle periods, e.g.
+     * between frames, that ended without a wait. The short gaps between
+     * commands inside a burst would only pull the limit down, so they are
+     * ignored. If we ended up waiting for the event anyway, the spinning
+     * was wasted, so back off. */
+    if (waited)
+        limit -= limit / 8;
+    else if (spin_count * 2 > limit)
+        limit += ((int)min(spin_count * 2, WINED3D_CS_SPIN_COUNT) - limit) / 8;
+
+    cs->spin_limit = max(limit, WINED3D_CS_SPIN_COUNT_MIN);
+}
+
 static void wined3d_cs_command_lock(const struct wined3d_cs *cs)
 {
     if (cs->serialize_commands)
@@ -3394,6 +3516,7 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
     enum wined3d_cs_op opcode;
     HMODULE wined3d_module;
     unsigned int poll = 0;
+    BOOL waited = FALSE;
     SIZE_T tail;
 
     TRACE("Started.\n");
@@ -3420,12 +3543,20 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
             queue = &cs->queue[WINED3D_CS_QUEUE_DEFAULT];
             if (wined3d_cs_queue_is_empty(cs, queue))
             {
-                if (++spin_count >= WINED3D_CS_SPIN_COUNT && list_empty(&cs->query_poll_list))
+                if (++spin_count >= cs->spin_limit && list_empty(&cs->query_poll_list))
+                {
                     wined3d_cs_wait_event(cs);
+                    if (cs->op_stats)
+                        ++cs->wait_count;
+                    waited = TRUE;
+                }
                 continue;
             }
         }
+        if (spin_count)
+            wined3d_cs_update_spin_limit(cs, spin_count, waited);
         spin_count = 0;
+        waited = FALSE;
 
         tail = queue->tail;
         packet = wined3d_next_cs_packet(queue->data, &tail);
@@ -3442,13 +3573,16 @@ static DWORD WINAPI wined3d_cs_run(void *ctx)
             }
 
             wined3d_cs_command_lock(cs);
-            wined3d_cs_op_handlers[opcode](cs, packet->data);
+            wined3d_cs_exec_op(cs, opcode, packet->data);
             wined3d_cs_command_unlock(cs);
             TRACE("%s at %p executed.\n", debug_cs_op(opcode), packet);
         }
 
         tail &= (WINED3D_CS_QUEUE_SIZE - 1);
         InterlockedExchange(&queue->tail, tail);
+
+        if (*(volatile BOOL *)&cs->waiting_for_space)
+            RtlWakeAddressAll(&queue->tail);
     }
 
     cs->queue[WINED3D_CS_QUEUE_MAP].tail = cs->queue[WINED3D_CS_QUEUE_MAP].head;
@@ -3481,6 +3615,12 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device,
 
     state_init(&cs->state, d3d_info, WINED3D_STATE_NO_REF | WINED3D_STATE_INIT_DEFAULT, cs->c.state->feature_level);
 
+    if (TRACE_ON(d3d_perf))
+    {
+        cs->op_stats = heap_alloc_zero(WINED3D_CS_OP_STOP * sizeof(*cs->op_stats));
+        QueryPerformanceCounter(&cs->op_stats_time);
+    }
+
     cs->data_size = WINED3D_INITIAL_CS_SIZE;
     if (!(cs->data = heap_alloc(cs->data_size)))
         goto fail;
@@ -3489,6 +3629,7 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device,
             && !RtlIsCriticalSectionLockedByThread(NtCurrentTeb()->Peb->LoaderLock))
     {
         cs->c.ops = &wined3d_cs_mt_ops;
+        cs->spin_limit = WINED3D_CS_SPIN_COUNT;
 
         if (!(cs->event = CreateEventW(NULL, FALSE, FALSE, NULL)))
         {
@@ -3521,6 +3662,7 @@ struct wined3d_cs *wined3d_cs_create(struct wined3d_device *device,
 fail:
     wined3d_state_destroy(cs->c.state);
     state_cleanup(&cs->state);
+    heap_free(cs->op_stats);
     heap_free(cs);
     return NULL;
 }
@@ -3537,6 +3679,7 @@ void wined3d_cs_destroy(struct wined3d_cs *cs)
 
     wined3d_state_destroy(cs->c.state);
     state_cleanup(&cs->state);
+    heap_free(cs->op_stats);
     heap_free(cs->data);
     heap_free(cs);
 }
@@ -3985,8 +4128,7 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
             + deferred->query_count * sizeof(*object->queries)
             + deferred->blend_state_count * sizeof(*object->blend_states)
             + deferred->rasterizer_state_count * sizeof(*object->rasterizer_states)
-            + deferred->depth_stencil_state_count * sizeof(*object->depth_stencil_states)
-            + deferred->data_size);
+            + deferred->depth_stencil_state_count * sizeof(*object->depth_stencil_states));
 
     if (!memory)
     {
@@ -4045,10 +4187,16 @@ HRESULT CDECL wined3d_deferred_context_record_command_list(struct wined3d_device
             deferred->depth_stencil_state_count * sizeof(*object->depth_stencil_states));
     /* Transfer our references to the depth stencil states to the command list. */
 
-    object->data = memory;
+    /* Transfer the packet data to the command list instead of copying it,
+     * trimming the unused capacity if possible. Start the next recording with
+     * a buffer of the same capacity, so that it doesn't have to grow it again
+     * one reallocation at a time. */
     object->data_size = deferred->data_size;
-    memcpy(object->data, deferred->data, deferred->data_size);
+    if (!object->data_size || !(object->data = heap_realloc(deferred->data, object->data_size)))
+        object->data = deferred->data;
 
+    if (!(deferred->data = heap_alloc(deferred->data_capacity)))
+        deferred->data_capacity = 0;
     deferred->data_size = 0;
     deferred->resource_count = 0;
     deferred->upload_count = 0;
@@ -4081,6 +4229,7 @@ static void wined3d_command_list_destroy_object(void *object)
     for (i = 0; i < list->upload_count; ++i)
         heap_free(list->uploads[i].sysmem);
 
+    heap_free(list->data);
     heap_free(list);
 }
 
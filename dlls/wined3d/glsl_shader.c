@@ -565,7 +565,44 @@ static void shader_glsl_compile(const struct wined3d_gl_info *gl_info, GLuint sh
     checkGLcall("glShaderSource");
     GL_EXTCALL(glCompileShader(shader));
     checkGLcall("glCompileShader");
-    print_glsl_info_log(gl_info, shader, FALSE);
+}
+
+/* Context activation is done by the caller. */
+static GLuint shader_glsl_compile_cached(const struct wined3d_gl_info *gl_info, GLenum type, const char *src)
+{
+    GLuint shader_id;
+
+    shader_id = GL_EXTCALL(glCreateShader(type));
+    TRACE("Compiling cached shader object %u.\n", shader_id);
+    shader_glsl_compile(gl_info, shader_id, src);
+
+    return shader_id;
+}
+
+/* Everything besides the shader itself and its compile arguments that
+ * affects the generated GLSL. */
+static uint64_t shader_glsl_get_cache_signature(const struct wined3d_context_gl *context_gl)
+{
+    const struct wined3d_d3d_info *d3d_info = context_gl->c.d3d_info;
+    const struct wined3d_gl_info *gl_info = context_gl->gl_info;
+    uint64_t hash;
+
+    hash = wined3d_shader_cache_signature(&gl_info->glsl_version, sizeof(gl_info->glsl_version));
+    hash = wined3d_hash64(hash, &gl_info->limits, sizeof(gl_info->limits));
+    hash = wined3d_hash64(hash, &gl_info->quirks, sizeof(gl_info->quirks));
+    hash = wined3d_hash64(hash, gl_info->supported, sizeof(gl_info->supported));
+    hash = wined3d_hash64(hash, &d3d_info->limits, sizeof(d3d_info->limits));
+    hash = wined3d_hash64(hash, &d3d_info->wined3d_creation_flags, sizeof(d3d_info->wined3d_creation_flags));
+    hash = wined3d_hash64(hash, &d3d_info->feature_level, sizeof(d3d_info->feature_level));
+    /* Used for the sampler binding qualifiers of SM1-3 shaders. */
+    hash = wined3d_hash64(hash, context_gl->tex_unit_map, sizeof(context_gl->tex_unit_map));
+    hash = wined3d_hash64(hash, &wined3d_settings.offscreen_rendering_mode,
+            sizeof(wined3d_settings.offscreen_rendering_mode));
+    hash = wined3d_hash64(hash, &wined3d_settings.check_float_constants,
+            sizeof(wined3d_settings.check_float_constants));
+    hash = wined3d_hash64(hash, &wined3d_settings.strict_shader_math, sizeof(wined3d_settings.strict_shader_math));
+
+    return hash;
 }
 
 /* Context activation is done by the caller. */
@@ -608,6 +645,7 @@ static void shader_glsl_dump_program_source(const struct wined3d_gl_info *gl_inf
         FIXME("    GL_SHADER_TYPE: %s.\n", debug_gl_shader_type(tmp));
         GL_EXTCALL(glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &tmp));
         FIXME("    GL_COMPILE_STATUS: %d.\n", tmp);
+        print_glsl_info_log(gl_info, shaders[i], FALSE);
         FIXME("\n");
 
         ptr = source;
@@ -8511,6 +8549,8 @@ static GLuint find_glsl_fragment_shader(const struct wined3d_context_gl *context
     struct glsl_ps_compiled_shader *gl_shaders, *new_array;
     struct glsl_shader_private *shader_data;
     struct ps_np2fixup_info *np2fixup;
+    uint64_t signature = 0;
+    char *source;
     UINT i;
     DWORD new_size;
     GLuint ret;
@@ -8569,10 +8609,25 @@ static GLuint find_glsl_fragment_shader(const struct wined3d_context_gl *context
     memset(np2fixup, 0, sizeof(*np2fixup));
     *np2fixup_info = args->np2_fixup ? np2fixup : NULL;
 
+    if (wined3d_shader_cache_enabled())
+    {
+        signature = shader_glsl_get_cache_signature(context_gl);
+        if ((source = wined3d_shader_cache_load(shader, signature, args, sizeof(*args), np2fixup, sizeof(*np2fixup))))
+        {
+            ret = shader_glsl_compile_cached(context_gl->gl_info, GL_FRAGMENT_SHADER, source);
+            gl_shaders[shader_data->num_gl_shaders++].id = ret;
+            heap_free(source);
+            return ret;
+        }
+    }
+
     string_buffer_clear(buffer);
     ret = shader_glsl_generate_fragment_shader(context_gl, buffer, string_buffers, shader, args, np2fixup);
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
 
+    if (ret && wined3d_shader_cache_enabled())
+        wined3d_shader_cache_store(shader, signature, args, sizeof(*args), np2fixup, sizeof(*np2fixup), buffer->buffer);
+
     return ret;
 }
 
@@ -8605,6 +8660,8 @@ static GLuint find_glsl_vertex_shader(const struct wined3d_context_gl *context_g
     uint32_t use_map = context_gl->c.stream_info.use_map;
     struct glsl_shader_private *shader_data;
     unsigned int i, new_size;
+    uint64_t signature = 0;
+    char *source;
     GLuint ret;
 
     if (!shader->backend_data)
@@ -8654,10 +8711,25 @@ static GLuint find_glsl_vertex_shader(const struct wined3d_context_gl *context_g
 
     gl_shaders[shader_data->num_gl_shaders].args = *args;
 
+    if (wined3d_shader_cache_enabled())
+    {
+        signature = shader_glsl_get_cache_signature(context_gl);
+        if ((source = wined3d_shader_cache_load(shader, signature, args, sizeof(*args), NULL, 0)))
+        {
+            ret = shader_glsl_compile_cached(context_gl->gl_info, GL_VERTEX_SHADER, source);
+            gl_shaders[shader_data->num_gl_shaders++].id = ret;
+            heap_free(source);
+            return ret;
+        }
+    }
+
     string_buffer_clear(&priv->shader_buffer);
     ret = shader_glsl_generate_vertex_shader(context_gl, priv, shader, args);
     gl_shaders[shader_data->num_gl_shaders++].id = ret;
 
+    if (ret && wined3d_shader_cache_enabled())
+        wined3d_shader_cache_store(shader, signature, args, sizeof(*args), NULL, 0, priv->shader_buffer.buffer);
+
     return ret;
 }
 
@@ -10103,6 +10175,8 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
     struct glsl_shader_private *shader_data;
     struct glsl_shader_prog_link *entry;
     GLuint shader_id, program_id;
+    uint64_t signature = 0;
+    char *source = NULL;
 
     if (!(entry = heap_alloc(sizeof(*entry))))
     {
@@ -10131,8 +10205,24 @@ static HRESULT shader_glsl_compile_compute_shader(struct shader_glsl_priv *priv,
 
     TRACE("Compiling compute shader %p.\n", shader);
 
-    string_buffer_clear(buffer);
-    shader_id = shader_glsl_generate_compute_shader(context_gl, buffer, &priv->string_buffers, shader);
+    if (wined3d_shader_cache_enabled())
+    {
+        signature = shader_glsl_get_cache_signature(context_gl);
+        source = wined3d_shader_cache_load(shader, signature, NULL, 0, NULL, 0);
+    }
+
+    if (source)
+    {
+        shader_id = shader_glsl_compile_cached(gl_info, GL_COMPUTE_SHADER, source);
+        heap_free(source);
+    }
+    else
+    {
+        string_buffer_clear(buffer);
+        shader_id = shader_glsl_generate_compute_shader(context_gl, buffer, &priv->string_buffers, shader);
+        if (shader_id && wined3d_shader_cache_enabled())
+            wined3d_shader_cache_store(shader, signature, NULL, 0, NULL, 0, buffer->buffer);
+    }
     gl_shaders[shader_data->num_gl_shaders++].id = shader_id;
 
     program_id = GL_EXTCALL(glCreateProgram());
@@ -12919,9 +13009,7 @@ static GLuint glsl_blitter_generate_program(struct wined3d_glsl_blitter *blitter
         GL_EXTCALL(glBindFragDataLocation(program, 0, "ps_out"));
 
     GL_EXTCALL(glCompileShader(vshader_id));
-    print_glsl_info_log(gl_info, vshader_id, FALSE);
     GL_EXTCALL(glCompileShader(fshader_id));
-    print_glsl_info_log(gl_info, fshader_id, FALSE);
     GL_EXTCALL(glLinkProgram(program));
     shader_glsl_validate_link(gl_info, program);
 
@@ -0,0 +1,238 @@
+/*
+ * Persistent cache of translated shader sources
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301, USA
+ */
+
+#include "config.h"
+#include <stdio.h>
+
+#include "wined3d_private.h"
+
+WINE_DEFAULT_DEBUG_CHANNEL(d3d_shader);
+
+/* Cache entries are stored one per file, named after a hash of everything
+ * that went into the translation. The entry itself contains the original
+ * byte code and compile arguments, and those are compared on lookup, so a
+ * hash collision can only result in a cache miss. */
+
+#define WINED3D_SHADER_CACHE_MAGIC      MAKEFOURCC('W','3','S','C')
+#define WINED3D_SHADER_CACHE_VERSION    1
+
+struct wined3d_shader_cache_header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t signature;
+    uint32_t shader_type;
+    uint32_t byte_code_size;
+    uint32_t args_size;
+    uint32_t extra_size;
+    uint32_t source_size;
+    uint32_t padding;
+};
+
+uint64_t wined3d_hash64(uint64_t hash, const void *data, size_t size)
+{
+    const uint8_t *p = data;
+
+    /* FNV-1a */
+    while (size--)
+    {
+        hash ^= *p++;
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+static uint64_t wined3d_shader_cache_get_build_hash(void)
+{
+    static uint64_t build_hash;
+    const char *(CDECL *wine_get_build_id)(void);
+    const char *build_id = "";
+    uint64_t hash;
+
+    if ((hash = build_hash))
+        return hash;
+
+    if ((wine_get_build_id = (void *)GetProcAddress(GetModuleHandleA("ntdll.dll"), "wine_get_build_id")))
+        build_id = wine_get_build_id();
+
+    hash = wined3d_hash64(WINED3D_SHADER_CACHE_HASH_SEED, build_id, strlen(build_id));
+    build_hash = hash;
+
+    return hash;
+}
+
+static BOOL wined3d_shader_cache_get_path(char *path, size_t size, const struct wined3d_shader *shader,
+        uint64_t signature, const void *args, size_t args_size)
+{
+    enum wined3d_shader_type type = shader->reg_maps.shader_version.type;
+    uint64_t hash;
+    int len;
+
+    hash = wined3d_hash64(signature, &type, sizeof(type));
+    hash = wined3d_hash64(hash, shader->byte_code, shader->byte_code_size);
+    hash = wined3d_hash64(hash, args, args_size);
+
+    len = snprintf(path, size, "%s\\%08x%08x.w3dsc", wined3d_settings.shader_cache_path,
+            (unsigned int)(hash >> 32), (unsigned int)hash);
+
+    return len > 0 && len < size;
+}
+
+static BOOL read_data(HANDLE file, void *data, DWORD size)
+{
+    DWORD read;
+
+    return !size || (ReadFile(file, data, size, &read, NULL) && read == size);
+}
+
+static BOOL write_data(HANDLE file, const void *data, DWORD size)
+{
+    DWORD written;
+
+    return !size || (WriteFile(file, data, size, &written, NULL) && written == size);
+}
+
+/* The signature identifies the backend configuration the source was
+ * generated for, and is included in the lookup key. */
+uint64_t wined3d_shader_cache_signature(const void *data, size_t size)
+{
+    return wined3d_hash64(wined3d_shader_cache_get_build_hash(), data, size);
+}
+
+char *wined3d_shader_cache_load(const struct wined3d_shader *shader, uint64_t signature,
+        const void *args, size_t args_size, void *extra, size_t extra_size)
+{
+    struct wined3d_shader_cache_header header;
+    char path[MAX_PATH];
+    void *data = NULL;
+    char *source;
+    HANDLE file;
+
+    if (!wined3d_shader_cache_get_path(path, sizeof(path), shader, signature, args, args_size))
+        return NULL;
+
+    if ((file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+            NULL, OPEN_EXISTING, 0, NULL)) == INVALID_HANDLE_VALUE)
+    {
+        TRACE("No cache entry %s for shader %p.\n", debugstr_a(path), shader);
+        return NULL;
+    }
+
+    if (!read_data(file, &header, sizeof(header))
+            || header.magic != WINED3D_SHADER_CACHE_MAGIC
+            || header.version != WINED3D_SHADER_CACHE_VERSION
+            || header.signature != signature
+            || header.shader_type != shader->reg_maps.shader_version.type
+            || header.byte_code_size != shader->byte_code_size
+            || header.args_size != args_size
+            || header.extra_size != extra_size
+            || !header.source_size)
+        goto fail;
+
+    if (!(data = heap_alloc(max(header.byte_code_size, header.args_size))))
+        goto fail;
+
+    if (!read_data(file, data, header.byte_code_size)
+            || memcmp(data, shader->byte_code, header.byte_code_size))
+        goto fail;
+    if (!read_data(file, data, header.args_size) || (args_size && memcmp(data, args, args_size)))
+        goto fail;
+    if (!read_data(file, extra, header.extra_size))
+        goto fail;
+
+    if (!(source = heap_alloc(header.source_size + 1)))
+        goto fail;
+    if (!read_data(file, source, header.source_size))
+    {
+        heap_free(source);
+        goto fail;
+    }
+    source[header.source_size] = 0;
+
+    TRACE("Loaded cache entry %s for shader %p.\n", debugstr_a(path), shader);
+
+    heap_free(data);
+    CloseHandle(file);
+    return source;
+
+fail:
+    WARN("Ignoring mismatching or corrupt cache entry %s.\n", debugstr_a(path));
+    if (extra_size)
+        memset(extra, 0, extra_size);
+    heap_free(data);
+    CloseHandle(file);
+    return NULL;
+}
+
+void wined3d_shader_cache_store(const struct wined3d_shader *shader, uint64_t signature,
+        const void *args, size_t args_size, const void *extra, size_t extra_size, const char *source)
+{
+    struct wined3d_shader_cache_header header;
+    char path[MAX_PATH], tmp_path[MAX_PATH];
+    HANDLE file;
+    int len;
+
+    if (!wined3d_shader_cache_get_path(path, sizeof(path), shader, signature, args, args_size))
+        return;
+
+    /* Write to a temporary file first, so that other processes sharing the
+     * cache never see partially written entries. */
+    len = snprintf(tmp_path, sizeof(tmp_path), "%s.%x.%x", path, GetCurrentProcessId(), GetCurrentThreadId());
+    if (len <= 0 || len >= sizeof(tmp_path))
+        return;
+
+    CreateDirectoryA(wined3d_settings.shader_cache_path, NULL);
+    if ((file = CreateFileA(tmp_path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, 0, NULL)) == INVALID_HANDLE_VALUE)
+    {
+        WARN("Failed to create cache entry %s, error %u.\n", debugstr_a(tmp_path), GetLastError());
+        return;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = WINED3D_SHADER_CACHE_MAGIC;
+    header.version = WINED3D_SHADER_CACHE_VERSION;
+    header.signature = signature;
+    header.shader_type = shader->reg_maps.shader_version.type;
+    header.byte_code_size = shader->byte_code_size;
+    header.args_size = args_size;
+    header.extra_size = extra_size;
+    header.source_size = strlen(source);
+
+    if (!write_data(file, &header, sizeof(header))
+            || !write_data(file, shader->byte_code, header.byte_code_size)
+            || !write_data(file, args, header.args_size)
+            || !write_data(file, extra, header.extra_size)
+            || !write_data(file, source, header.source_size))
+    {
+        WARN("Failed to write cache entry %s, error %u.\n", debugstr_a(tmp_path), GetLastError());
+        CloseHandle(file);
+        DeleteFileA(tmp_path);
+        return;
+    }
+    CloseHandle(file);
+
+    if (!MoveFileExA(tmp_path, path, MOVEFILE_REPLACE_EXISTING))
+    {
+        WARN("Failed to rename cache entry %s, error %u.\n", debugstr_a(tmp_path), GetLastError());
+        DeleteFileA(tmp_path);
+        return;
+    }
+
+    TRACE("Stored cache entry %s for shader %p.\n", debugstr_a(path), shader);
+}
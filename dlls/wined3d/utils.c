@@ -2469,9 +2469,7 @@ static void draw_test_quad(struct wined3d_caps_gl_ctx *ctx, const struct wined3d
             GL_EXTCALL(glBindFragDataLocation(ctx->test_program_id, 0, "fragment_color"));
 
         GL_EXTCALL(glCompileShader(vs_id));
-        print_glsl_info_log(gl_info, vs_id, FALSE);
         GL_EXTCALL(glCompileShader(fs_id));
-        print_glsl_info_log(gl_info, fs_id, FALSE);
         GL_EXTCALL(glLinkProgram(ctx->test_program_id));
         shader_glsl_validate_link(gl_info, ctx->test_program_id);
     }
@@ -85,6 +85,7 @@ enum wined3d_gl_extension
     ARB_MULTISAMPLE,
     ARB_MULTITEXTURE,
     ARB_OCCLUSION_QUERY,
+    ARB_PARALLEL_SHADER_COMPILE,
     ARB_PIPELINE_STATISTICS_QUERY,
     ARB_PIXEL_BUFFER_OBJECT,
     ARB_POINT_PARAMETERS,
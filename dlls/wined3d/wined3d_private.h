@@ -497,6 +497,7 @@ struct wined3d_settings
     enum wined3d_renderer renderer;
     enum wined3d_shader_backend shader_backend;
     BOOL cb_access_map_w;
+    char *shader_cache_path;
 };
 
 extern struct wined3d_settings wined3d_settings DECLSPEC_HIDDEN;
@@ -4845,7 +4846,9 @@ enum wined3d_push_constants
 
 #define WINED3D_CS_QUERY_POLL_INTERVAL  10u
 #define WINED3D_CS_QUEUE_SIZE           0x100000u
+#define WINED3D_CS_QUEUE_SPIN_COUNT     1000u
 #define WINED3D_CS_SPIN_COUNT           10000000u
+#define WINED3D_CS_SPIN_COUNT_MIN       1000000u
 
 struct wined3d_cs_queue
 {
@@ -4901,7 +4904,15 @@ struct wined3d_cs
 
     HANDLE event;
     BOOL waiting_for_event;
+    BOOL waiting_for_space;
+    unsigned int spin_limit; /* only accessed from the CS thread once started */
     LONG pending_presents;
+
+    struct wined3d_cs_op_stats *op_stats;
+    LARGE_INTEGER op_stats_time;
+    ULONG64 stall_ticks;
+    unsigned int stall_count, wait_count;
+    size_t max_queue_usage;
 };
 
 static inline void wined3d_device_context_lock(struct wined3d_device_context *context)
@@ -5765,6 +5776,21 @@ void find_ds_compile_args(const struct wined3d_state *state, const struct wined3
 void find_gs_compile_args(const struct wined3d_state *state, const struct wined3d_shader *shader,
         struct gs_compile_args *args, const struct wined3d_context *context) DECLSPEC_HIDDEN;
 
+#define WINED3D_SHADER_CACHE_HASH_SEED 0xcbf29ce484222325ull
+
+uint64_t wined3d_hash64(uint64_t hash, const void *data, size_t size) DECLSPEC_HIDDEN;
+uint64_t wined3d_shader_cache_signature(const void *data, size_t size) DECLSPEC_HIDDEN;
+char *wined3d_shader_cache_load(const struct wined3d_shader *shader, uint64_t signature,
+        const void *args, size_t args_size, void *extra, size_t extra_size) DECLSPEC_HIDDEN;
+void wined3d_shader_cache_store(const struct wined3d_shader *shader, uint64_t signature,
+        const void *args, size_t args_size, const void *extra, size_t extra_size,
+        const char *source) DECLSPEC_HIDDEN;
+
+static inline BOOL wined3d_shader_cache_enabled(void)
+{
+    return !!wined3d_settings.shader_cache_path;
+}
+
 void string_buffer_clear(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
 BOOL string_buffer_init(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
 void string_buffer_free(struct wined3d_string_buffer *buffer) DECLSPEC_HIDDEN;
@@ -1838,6 +1838,23 @@ static DWORD refill_buffer( struct request *request, BOOL notify )
     return ERROR_SUCCESS;
 }
 
+/* read directly into the caller's buffer when the read buffer is empty */
+static DWORD read_data_direct( struct request *request, char *buffer, DWORD size, int *len, BOOL notify )
+{
+    DWORD ret;
+
+    if (request->content_length != ~0u) size = min( size, request->content_length - request->content_read );
+
+    if (notify) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_RECEIVING_RESPONSE, NULL, 0 );
+
+    ret = netconn_recv( request->netconn, buffer, size, 0, len );
+
+    if (notify) send_callback( &request->hdr, WINHTTP_CALLBACK_STATUS_RESPONSE_RECEIVED, len, sizeof(*len) );
+
+    if (!ret && !*len) request->content_length = request->content_read = 0;
+    return ret;
+}
+
 static void finished_reading( struct request *request )
 {
     BOOL close = FALSE;
@@ -1886,15 +1903,24 @@ static DWORD read_data( struct request *request, void *buffer, DWORD size, DWORD
 
     while (size)
     {
-        if (!(count = get_available_data( request )))
+        if (!(count = get_available_data( request )) && !request->read_chunked && size >= sizeof(request->read_buf))
+        {
+            /* large reads don't need to go through the read buffer */
+            if ((ret = read_data_direct( request, (char *)buffer + bytes_read, size, &count, async ))) goto done;
+            if (!count) goto done;
+        }
+        else
         {
-            if ((ret = refill_buffer( request, async ))) goto done;
-            if (!(count = get_available_data( request ))) goto done;
+            if (!count)
+            {
+                if ((ret = refill_buffer( request, async ))) goto done;
+                if (!(count = get_available_data( request ))) goto done;
+            }
+            count = min( count, size );
+            memcpy( (char *)buffer + bytes_read, request->read_buf + request->read_pos, count );
+            remove_data( request, count );
+            if (request->read_chunked) request->read_chunked_size -= count;
         }
-        count = min( count, size );
-        memcpy( (char *)buffer + bytes_read, request->read_buf + request->read_pos, count );
-        remove_data( request, count );
-        if (request->read_chunked) request->read_chunked_size -= count;
         size -= count;
         bytes_read += count;
         request->content_read += count;
@@ -185,6 +185,7 @@ typedef struct
     char *cache_prefix; /* string that has to be prefixed for this container to be used */
     LPWSTR path; /* path to url container directory */
     HANDLE mapping; /* handle of file mapping */
+    urlcache_header *header; /* view of the mapping, kept between index locks */
     DWORD file_size; /* size of file when mapping was opened */
     HANDLE mutex; /* handle of mutex */
     DWORD default_entry_type;
@@ -673,8 +674,15 @@ static DWORD cache_container_open_index(cache_container *container, DWORD blocks
  */
 static void cache_container_close_index(cache_container *pContainer)
 {
+    WaitForSingleObject(pContainer->mutex, INFINITE);
+    if (pContainer->header)
+    {
+        UnmapViewOfFile(pContainer->header);
+        pContainer->header = NULL;
+    }
     CloseHandle(pContainer->mapping);
     pContainer->mapping = NULL;
+    ReleaseMutex(pContainer->mutex);
 }
 
 static BOOL cache_containers_add(const char *cache_prefix, LPCWSTR path,
@@ -689,6 +697,7 @@ static BOOL cache_containers_add(const char *cache_prefix, LPCWSTR path,
     }
 
     pContainer->mapping = NULL;
+    pContainer->header = NULL;
     pContainer->file_size = 0;
     pContainer->default_entry_type = default_entry_type;
 
@@ -891,22 +900,27 @@ static urlcache_header* cache_container_lock_index(cache_container *pContainer)
     /* acquire mutex */
     WaitForSingleObject(pContainer->mutex, INFINITE);
 
-    pIndexData = MapViewOfFile(pContainer->mapping, FILE_MAP_WRITE, 0, 0, 0);
-
-    if (!pIndexData)
+    /* the view is kept mapped between locks, so that the common case
+     * doesn't need to map and unmap the whole index every time */
+    if (!pContainer->header)
     {
-        ReleaseMutex(pContainer->mutex);
-        ERR("Couldn't MapViewOfFile. Error: %d\n", GetLastError());
-        return NULL;
+        pIndexData = MapViewOfFile(pContainer->mapping, FILE_MAP_WRITE, 0, 0, 0);
+
+        if (!pIndexData)
+        {
+            ReleaseMutex(pContainer->mutex);
+            ERR("Couldn't MapViewOfFile. Error: %d\n", GetLastError());
+            return NULL;
+        }
+        pContainer->header = pIndexData;
     }
-    pHeader = (urlcache_header*)pIndexData;
+    pHeader = pContainer->header;
 
     /* file has grown - we need to remap to prevent us getting
      * access violations when we try and access beyond the end
      * of the memory mapped file */
     if (pHeader->size != pContainer->file_size)
     {
-        UnmapViewOfFile( pHeader );
         cache_container_close_index(pContainer);
         error = cache_container_open_index(pContainer, MIN_BLOCK_NO);
         if (error != ERROR_SUCCESS)
@@ -923,7 +937,7 @@ static urlcache_header* cache_container_lock_index(cache_container *pContainer)
             ERR("Couldn't MapViewOfFile. Error: %d\n", GetLastError());
             return NULL;
         }
-        pHeader = (urlcache_header*)pIndexData;
+        pHeader = pContainer->header = pIndexData;
     }
 
     TRACE("Signature: %s, file size: %d bytes\n", pHeader->signature, pHeader->size);
@@ -943,8 +957,7 @@ static urlcache_header* cache_container_lock_index(cache_container *pContainer)
 static BOOL cache_container_unlock_index(cache_container *pContainer, urlcache_header *pHeader)
 {
     /* release mutex */
-    ReleaseMutex(pContainer->mutex);
-    return UnmapViewOfFile(pHeader);
+    return ReleaseMutex(pContainer->mutex);
 }
 
 /***********************************************************************
@@ -1161,7 +1174,7 @@ static BOOL urlcache_clean_leaked_entries(cache_container *container, urlcache_h
 static DWORD cache_container_clean_index(cache_container *container, urlcache_header **file_view)
 {
     urlcache_header *header = *file_view;
-    DWORD ret;
+    DWORD blocks_no, file_size, ret;
 
     TRACE("(%s %s)\n", debugstr_a(container->cache_prefix), debugstr_w(container->path));
 
@@ -1173,16 +1186,24 @@ static DWORD cache_container_clean_index(cache_container *container, urlcache_he
         return ERROR_NOT_ENOUGH_MEMORY;
     }
 
+    /* keep the current view mapped, the caller still uses it on failure */
+    blocks_no = header->capacity_in_blocks*2;
+    file_size = container->file_size;
+    container->header = NULL;
     cache_container_close_index(container);
-    ret = cache_container_open_index(container, header->capacity_in_blocks*2);
-    if(ret != ERROR_SUCCESS)
+    ret = cache_container_open_index(container, blocks_no);
+    if(ret == ERROR_SUCCESS && !(header = MapViewOfFile(container->mapping, FILE_MAP_WRITE, 0, 0, 0)))
+        ret = GetLastError();
+    if(ret != ERROR_SUCCESS) {
+        /* the old view only covers the old size, make sure it gets
+         * remapped on next lock if the file has grown */
+        container->header = *file_view;
+        container->file_size = file_size;
         return ret;
-    header = MapViewOfFile(container->mapping, FILE_MAP_WRITE, 0, 0, 0);
-    if(!header)
-        return GetLastError();
+    }
 
     UnmapViewOfFile(*file_view);
-    *file_view = header;
+    container->header = *file_view = header;
     return ERROR_SUCCESS;
 }
 
@@ -201,9 +201,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wsize - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -212,16 +211,14 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         op -= wnext;
                         if (op < len) {         /* some from end of window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
                             from = window;
                             if (wnext < len) {  /* some from start of window */
                                 op = wnext;
                                 len -= op;
-                                do {
-                                    *out++ = *from++;
-                                } while (--op);
+                                zmemcpy(out, from, op);
+                                out += op;
                                 from = out - dist;      /* rest from output */
                             }
                         }
@@ -230,9 +227,8 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                         from += wnext - op;
                         if (op < len) {         /* some from window */
                             len -= op;
-                            do {
-                                *out++ = *from++;
-                            } while (--op);
+                            zmemcpy(out, from, op);
+                            out += op;
                             from = out - dist;  /* rest from output */
                         }
                     }
@@ -250,12 +246,20 @@ unsigned start;         /* inflate()'s starting value for strm->avail_out */
                 }
                 else {
                     from = out - dist;          /* copy direct from output */
-                    do {                        /* minimum length is three */
+                    if (dist >= 8) {            /* non-overlapping chunks */
+                        while (len >= 8) {
+                            zmemcpy(out, from, 8);
+                            out += 8;
+                            from += 8;
+                            len -= 8;
+                        }
+                    }
+                    while (len > 2) {           /* minimum length is three */
                         *out++ = *from++;
                         *out++ = *from++;
                         *out++ = *from++;
                         len -= 3;
-                    } while (len > 2);
+                    }
                     if (len) {
                         *out++ = *from++;
                         if (len > 1)
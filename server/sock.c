@@ -2976,30 +2976,27 @@ static void sock_ioctl( struct fd *fd, ioctl_code_t code, struct async *async )
     }
 }
 
-static int poll_single_socket( struct sock *sock, int mask )
+static int poll_single_socket( struct sock *sock, int mask, const struct pollfd *pollfd )
 {
-    struct pollfd pollfd;
+    int revents = pollfd->revents;
 
-    pollfd.fd = get_unix_fd( sock->fd );
-    pollfd.events = poll_flags_from_afd( sock, mask );
-    if (pollfd.events < 0 || poll( &pollfd, 1, 0 ) < 0)
-        return 0;
+    if (pollfd->events < 0) return 0;
 
-    if (sock->state == SOCK_CONNECTING && (pollfd.revents & (POLLERR | POLLHUP)))
-        pollfd.revents &= ~POLLOUT;
+    if (sock->state == SOCK_CONNECTING && (revents & (POLLERR | POLLHUP)))
+        revents &= ~POLLOUT;
 
-    if ((mask & AFD_POLL_HUP) && (pollfd.revents & POLLIN) && sock->type == WS_SOCK_STREAM)
+    if ((mask & AFD_POLL_HUP) && (revents & POLLIN) && sock->type == WS_SOCK_STREAM)
     {
         char dummy;
 
         if (!recv( get_unix_fd( sock->fd ), &dummy, 1, MSG_PEEK ))
         {
-            pollfd.revents &= ~POLLIN;
-            pollfd.revents |= POLLHUP;
+            revents &= ~POLLIN;
+            revents |= POLLHUP;
         }
     }
 
-    return get_poll_flags( sock, pollfd.revents ) & mask;
+    return get_poll_flags( sock, revents ) & mask;
 }
 
 static void handle_exclusive_poll(struct poll_req *req)
@@ -3026,6 +3023,7 @@ static void poll_socket( struct sock *poll_sock, struct async *async, int exclus
                          unsigned int count, const struct afd_poll_socket_64 *sockets )
 {
     BOOL signaled = FALSE;
+    struct pollfd *pollfds;
     struct poll_req *req;
     unsigned int i, j;
 
@@ -3035,14 +3033,21 @@ static void poll_socket( struct sock *poll_sock, struct async *async, int exclus
         return;
     }
 
+    if (!(pollfds = mem_alloc( count * sizeof(*pollfds) )))
+        return;
+
     if (!(req = mem_alloc( offsetof( struct poll_req, sockets[count] ) )))
+    {
+        free( pollfds );
         return;
+    }
 
     req->timeout = NULL;
     if (timeout && timeout != TIMEOUT_INFINITE &&
         !(req->timeout = add_timeout_user( timeout, async_poll_timeout, req )))
     {
         free( req );
+        free( pollfds );
         return;
     }
     req->orig_timeout = timeout;
@@ -3055,6 +3060,7 @@ static void poll_socket( struct sock *poll_sock, struct async *async, int exclus
             for (j = 0; j < i; ++j) release_object( req->sockets[j].sock );
             if (req->timeout) remove_timeout_user( req->timeout );
             free( req );
+            free( pollfds );
             return;
         }
         req->sockets[i].handle = sockets[i].socket;
@@ -3073,11 +3079,26 @@ static void poll_socket( struct sock *poll_sock, struct async *async, int exclus
     async_set_completion_callback( async, free_poll_req, req );
     queue_async( &poll_sock->poll_q, async );
 
+    /* check the current state of all the sockets with a single poll() call;
+     * a negative fd makes poll() skip the entry, and events < 0 marks it */
+    for (i = 0; i < count; ++i)
+    {
+        struct sock *sock = req->sockets[i].sock;
+
+        pollfds[i].events = poll_flags_from_afd( sock, req->sockets[i].mask );
+        pollfds[i].fd = pollfds[i].events < 0 ? -1 : get_unix_fd( sock->fd );
+        pollfds[i].revents = 0;
+    }
+    if (poll( pollfds, count, 0 ) < 0)
+    {
+        for (i = 0; i < count; ++i) pollfds[i].events = -1;
+    }
+
     for (i = 0; i < count; ++i)
     {
         struct sock *sock = req->sockets[i].sock;
         int mask = req->sockets[i].mask;
-        int flags = poll_single_socket( sock, mask );
+        int flags = poll_single_socket( sock, mask, &pollfds[i] );
 
         if (flags)
         {
@@ -3095,6 +3116,8 @@ static void poll_socket( struct sock *poll_sock, struct async *async, int exclus
         }
     }
 
+    free( pollfds );
+
     if (!timeout || signaled)
         complete_async_poll( req, STATUS_SUCCESS );
 